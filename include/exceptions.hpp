@@ -32,4 +32,11 @@ public:
   }
 };
 
+class memory_budget_exceeded : public std::exception {
+public:
+  [[nodiscard]] const char *what() const noexcept override {
+    return "A fa elerte a memoriakeretet!";
+  }
+};
+
 #endif // EXCEPTIONS_HPP_INCLUDED
@@ -0,0 +1,343 @@
+#ifndef LLRB_TREE_HPP_INCLUDED
+#define LLRB_TREE_HPP_INCLUDED
+
+#include "exceptions.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+// Balra dőlő piros-fekete fa (Sedgewick-féle LLRB).
+// Az rb_tree alternatívája: a csúcsokban nincs szülő pointer, a
+// kiegyensúlyozás a keresés útvonalán, rekurzívan történik, így nincs
+// külön alulról felfelé haladó javító menet. A levelek nullptr-ek,
+// nincs statikus empty_leaf sem, így a fa fordítási időben (constexpr
+// kiértékelésben) is használható.
+
+//
+// Balra dőlő piros-fekete fa osztály
+// DEFINÍCIÓ
+//
+template <class T> class llrb_tree {
+
+  // Szín felsoroló típus
+  enum color_t { black, red };
+
+  // Belső csúcs struktúra - szülő pointer nélkül
+  struct node {
+    node *left, *right;
+    color_t color;
+    T key;
+
+    // Konstruktor csúcs létrehozására beszúráskor
+    constexpr explicit node(const T &k) : left(nullptr), right(nullptr), color(red), key(k) {}
+  };
+
+  // Peldany valtozo
+  node *root;
+
+  // Felszabadító függvény
+  static constexpr void _destroy(node *x);
+
+  // Segédfüggvények
+  static constexpr bool _is_red(const node *x) { return x != nullptr && x->color == red; }
+  static constexpr node *_min(node *x);
+  static constexpr size_t _size(const node *x);
+
+  // Kiegyensúlyozásért felelős függvények
+  // Mindegyik az új részfa-gyökeret adja vissza.
+  static constexpr node *_rotate_left(node *x);
+  static constexpr node *_rotate_right(node *x);
+  static constexpr void _flip_colors(node *x);
+  static constexpr node *_move_red_left(node *x);
+  static constexpr node *_move_red_right(node *x);
+  static constexpr node *_balance(node *x);
+
+  static constexpr node *_insert(node *x, const T &k);
+  static constexpr node *_remove_min(node *x);
+  static constexpr node *_remove(node *x, const T &k);
+
+  // Ellenőrző segédfüggvények
+  static constexpr size_t _validate(const node *x);
+
+public:
+  // Konstruktor és destruktor
+  constexpr llrb_tree() : root(nullptr) {}
+  constexpr ~llrb_tree() { _destroy(root); }
+
+  // Másoló konstruktor és operátor egyelőre nincs implementálva
+  llrb_tree(const llrb_tree & /*t*/) { throw copy_not_implemented(); }
+  llrb_tree &operator=(const llrb_tree & /*t*/) { throw copy_not_implemented(); }
+
+  // Alapműveletek
+  [[nodiscard]] constexpr size_t size() const { return _size(root); }
+
+  constexpr bool find(const T &k) const;
+  constexpr void insert(const T &k);
+  constexpr void remove(const T &k);
+
+  // Inorder bejárás explicit veremmel, minden kulcsra meghívja f-et.
+  template <class F> constexpr void for_each(F f) const;
+
+  // Egy csúcs mérete bájtban (összehasonlításhoz az rb_tree-vel)
+  static constexpr size_t node_size() { return sizeof(node); }
+
+  // Ellenőrző függvény
+  constexpr void validate() const;
+};
+
+//
+// Balra dőlő piros-fekete fa osztály
+// FÜGGVÉNYIMPLEMENTÁCIÓK
+//
+// Felszabadítja a csúcsokat. Szülő pointer híján explicit vermet használ,
+// így elfajult fára sem fut ki a hívási veremből.
+template <class T> constexpr void llrb_tree<T>::_destroy(node *x) {
+  std::vector<node *> stack;
+  if (x != nullptr)
+    stack.push_back(x);
+  while (!stack.empty()) {
+    node *y = stack.back();
+    stack.pop_back();
+    if (y->left != nullptr)
+      stack.push_back(y->left);
+    if (y->right != nullptr)
+      stack.push_back(y->right);
+    delete y;
+  }
+}
+
+// Visszaadja az x gyökerű részfa legkisebb értékű csúcsát.
+// Előfeltétel: x != nullptr
+template <class T> constexpr typename llrb_tree<T>::node *llrb_tree<T>::_min(node *x) {
+  while (x->left != nullptr)
+    x = x->left;
+  return x;
+}
+
+// Rekurzívan meghatározza, és visszaadja
+// az x gyökerű részfa elemeinek számát.
+template <class T> constexpr size_t llrb_tree<T>::_size(const node *x) {
+  if (x == nullptr)
+    return 0;
+  return _size(x->left) + _size(x->right) + 1;
+}
+
+// Balra forgatás az x csúcs és a jobb gyereke közötti él mentén.
+// Az új gyökér örökli x színét, x pirossá válik.
+template <class T> constexpr typename llrb_tree<T>::node *llrb_tree<T>::_rotate_left(node *x) {
+  assert(nullptr != x && nullptr != x->right && "Balra forgatas nem letezo jobb gyerekkel");
+  node *y = x->right;
+  x->right = y->left;
+  y->left = x;
+  y->color = x->color;
+  x->color = red;
+  return y;
+}
+
+// Jobbra forgatás az x csúcs és a bal gyereke közötti él mentén.
+// Az új gyökér örökli x színét, x pirossá válik.
+template <class T> constexpr typename llrb_tree<T>::node *llrb_tree<T>::_rotate_right(node *x) {
+  assert(nullptr != x && nullptr != x->left && "Jobbra forgatas nem letezo bal gyerekkel");
+  node *y = x->left;
+  x->left = y->right;
+  y->right = x;
+  y->color = x->color;
+  x->color = red;
+  return y;
+}
+
+// Megfordítja x és két gyereke színét.
+// (2-3 fa nyelvén: 4-csúcs szétvágása, illetve összevonása)
+template <class T> constexpr void llrb_tree<T>::_flip_colors(node *x) {
+  x->color = x->color == red ? black : red;
+  x->left->color = x->left->color == red ? black : red;
+  x->right->color = x->right->color == red ? black : red;
+}
+
+// Lefelé haladva biztosítja, hogy x->left vagy annak bal gyereke piros legyen.
+// Előfeltétel: x piros, x->left és x->left->left fekete.
+template <class T> constexpr typename llrb_tree<T>::node *llrb_tree<T>::_move_red_left(node *x) {
+  _flip_colors(x);
+  if (_is_red(x->right->left)) {
+    x->right = _rotate_right(x->right);
+    x = _rotate_left(x);
+    _flip_colors(x);
+  }
+  return x;
+}
+
+// Lefelé haladva biztosítja, hogy x->right vagy annak bal gyereke piros legyen.
+// Előfeltétel: x piros, x->right és x->right->left fekete.
+template <class T> constexpr typename llrb_tree<T>::node *llrb_tree<T>::_move_red_right(node *x) {
+  _flip_colors(x);
+  if (_is_red(x->left->left)) {
+    x = _rotate_right(x);
+    _flip_colors(x);
+  }
+  return x;
+}
+
+// Helyreállítja a balra dőlő tulajdonságot x-ben, visszafelé jövet.
+template <class T> constexpr typename llrb_tree<T>::node *llrb_tree<T>::_balance(node *x) {
+  // 1. eset: jobbra dőlő piros él -> balra forgatás
+  if (_is_red(x->right) && !_is_red(x->left))
+    x = _rotate_left(x);
+  // 2. eset: két egymást követő bal piros él -> jobbra forgatás
+  if (_is_red(x->left) && _is_red(x->left->left))
+    x = _rotate_right(x);
+  // 3. eset: mindkét gyerek piros -> színcsere
+  if (_is_red(x->left) && _is_red(x->right))
+    _flip_colors(x);
+  return x;
+}
+
+// Rekurzív beszúrás az x gyökerű részfába, visszaadja az új részfa-gyökeret.
+template <class T> constexpr typename llrb_tree<T>::node *llrb_tree<T>::_insert(node *x, const T &k) {
+  if (x == nullptr)
+    return new node(k);
+
+  if (k < x->key)
+    x->left = _insert(x->left, k);
+  else if (k != x->key)
+    x->right = _insert(x->right, k);
+
+  return _balance(x);
+}
+
+// Törli az x gyökerű részfa legkisebb elemét.
+// Előfeltétel: x vagy x->left piros.
+template <class T> constexpr typename llrb_tree<T>::node *llrb_tree<T>::_remove_min(node *x) {
+  if (x->left == nullptr) {
+    delete x;
+    return nullptr;
+  }
+  if (!_is_red(x->left) && !_is_red(x->left->left))
+    x = _move_red_left(x);
+  x->left = _remove_min(x->left);
+  return _balance(x);
+}
+
+// Rekurzív törlés az x gyökerű részfából.
+// Előfeltétel: k szerepel a részfában, és x vagy x->left piros.
+template <class T> constexpr typename llrb_tree<T>::node *llrb_tree<T>::_remove(node *x, const T &k) {
+  if (k < x->key) {
+    if (!_is_red(x->left) && !_is_red(x->left->left))
+      x = _move_red_left(x);
+    x->left = _remove(x->left, k);
+  } else {
+    if (_is_red(x->left))
+      x = _rotate_right(x);
+    if (k == x->key && x->right == nullptr) {
+      delete x;
+      return nullptr;
+    }
+    if (!_is_red(x->right) && !_is_red(x->right->left))
+      x = _move_red_right(x);
+    if (k == x->key) {
+      // A rákövetkező kulcsát áthozzuk, majd a jobb részfából töröljük azt
+      x->key = _min(x->right)->key;
+      x->right = _remove_min(x->right);
+    } else {
+      x->right = _remove(x->right, k);
+    }
+  }
+  return _balance(x);
+}
+
+// Lekérdezi, hogy található-e k kulcs a fában.
+// Igazat ad vissza, ha található.
+template <class T> constexpr bool llrb_tree<T>::find(const T &k) const {
+  node *x = root;
+  while (x != nullptr && k != x->key)
+    if (k < x->key)
+      x = x->left;
+    else
+      x = x->right;
+  return x != nullptr;
+}
+
+// Beszúrja a k értéket a fába.
+// Ha már van k érték a fában, akkor nem csinál semmit.
+template <class T> constexpr void llrb_tree<T>::insert(const T &k) {
+  root = _insert(root, k);
+  root->color = black;
+}
+
+// Eltávolítja a k értéket a fából.
+// Ha nem volt k érték a fában, akkor nem csinál semmit.
+template <class T> constexpr void llrb_tree<T>::remove(const T &k) {
+  // A lefelé haladó törlés feltételezi, hogy a kulcs benne van a fában.
+  if (!find(k))
+    return;
+
+  // Ha a gyökér mindkét gyereke fekete, a gyökér ideiglenesen piros lesz
+  if (!_is_red(root->left) && !_is_red(root->right))
+    root->color = red;
+
+  root = _remove(root, k);
+  if (root != nullptr)
+    root->color = black;
+}
+
+// Inorder bejárás explicit veremmel (szülő pointer nélkül).
+template <class T> template <class F> constexpr void llrb_tree<T>::for_each(F f) const {
+  std::vector<const node *> stack;
+  const node *x = root;
+  while (x != nullptr || !stack.empty()) {
+    while (x != nullptr) {
+      stack.push_back(x);
+      x = x->left;
+    }
+    x = stack.back();
+    stack.pop_back();
+    f(x->key);
+    x = x->right;
+  }
+}
+
+// Rekurzív segédfüggvény a balra dőlő piros-fekete tulajdonságok
+// ellenőrzéséhez. Visszaadja a részfa fekete-magasságát.
+template <class T> constexpr size_t llrb_tree<T>::_validate(const node *x) {
+  if (x == nullptr)
+    return 0;
+
+  if (x->color != red && x->color != black)
+    throw invalid_rb_tree("Se nem piros, s nem fekete!");
+
+  // "Piros él csak balra dőlhet."
+  if (_is_red(x->right))
+    throw invalid_rb_tree("Jobbra dolo piros el.");
+
+  // "Minden piros csúcs mindkét gyereke fekete."
+  if (x->color == red && _is_red(x->left))
+    throw invalid_rb_tree("Piros csucsnak piros gyereke van.");
+
+  size_t left_black_height = _validate(x->left);
+  size_t right_black_height = _validate(x->right);
+  if (left_black_height != right_black_height)
+    throw invalid_rb_tree("A fekete magassag kulonbozik a ket oldalon.");
+  return left_black_height + (x->color == black);
+}
+
+// Ellenőrzi, hogy a fa érvényes bináris keresőfa,
+// illetve érvényes balra dőlő piros-fekete fa-e.
+template <class T> constexpr void llrb_tree<T>::validate() const {
+  // Keresőfa tulajdonság ellenőrzése bejárással
+  bool first = true;
+  T prev{};
+  for_each([&](const T &k) {
+    if (!first && !(prev < k))
+      throw invalid_binary_search_tree();
+    prev = k;
+    first = false;
+  });
+
+  // "A gyökér színe fekete."
+  if (_is_red(root))
+    throw invalid_rb_tree("gyoker nem fekete!");
+
+  _validate(root);
+}
+
+#endif // LLRB_TREE_HPP_INCLUDED
@@ -3,9 +3,16 @@
 
 #include "exceptions.hpp"
 
+#include <array>
 #include <cassert>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
 
-// Orai kod - statikus _min, _max, _prev, _next fuggvenyekkel
+// Orai kod - eredetileg statikus _min, _max, _prev, _next fuggvenyekkel.
+// Az empty_leaf mostantol peldanyonkent kulon csucs, igy a fa
+// forditasi idoben (constexpr kiertekelesben) is hasznalhato.
 
 //
 // Piros-fekete fa osztály
@@ -24,79 +31,263 @@ template <class T> class rb_tree {
     T key;
 
     // Az alapértelmezett konstruktor csak az empty_leaf létrehozására szolgál
-    node() : parent(this), left(this), right(this), color(black), key() {}
+    constexpr node() : parent(this), left(this), right(this), color(black), key() {}
 
     // Konstruktor csúcs létrehozására beszúráskor
-    node(const T &k, node *p) : parent(p), left(empty_leaf), right(empty_leaf), color(red), key(k) {}
+    constexpr node(const T &k, node *p, node *leaf)
+        : parent(p), left(leaf), right(leaf), color(red), key(k) {}
   };
 
   // Adattagok
-  // node() default konstruktor meghívása -> _empty_leaf létrejön
-  static inline node _empty_leaf;
+  // node() default konstruktor meghívása -> _empty_leaf létrejön.
+  // Minden fának saját példánya van: statikus, módosítható őrszem
+  // nem lehetne constexpr, és a törlés írja a szülő mezőjét.
+  node _empty_leaf;
   // empty_leaf a _empty_leaf-re mutató pointer
-  static inline node *empty_leaf = &_empty_leaf;
+  node *const empty_leaf = &_empty_leaf;
+
+  // A felszabadított csúcsok helyét tartalékoló szabadlista eleme
+  struct free_block {
+    free_block *next;
+  };
+  static_assert(sizeof(free_block) <= sizeof(node));
 
   // Peldany valtozo
   node *root;
 
-  // Felszabadító függvény
-  static void _destroy(node *x);
+  // Memória-nyilvántartás: élő csúcsok, szabadlistán tartalékolt
+  // csúcshelyek, és a bájtkeret (0 esetén nincs korlát).
+  size_t node_count = 0;
+  size_t pooled_count = 0;
+  free_block *pool = nullptr;
+  size_t byte_budget = 0;
+
+  // Ellenőrzési keret: ennyi csúcsot vizsgál a háttér-ellenőrzés
+  // módosító műveletenként. 0 esetén az ellenőrzés ki van kapcsolva.
+  size_t check_budget = 0;
+  // A háttér-ellenőrzés állapota: az utoljára ellenőrzött kulcs
+  mutable T sweep_key{};
+  mutable bool sweep_started = false;
+
+  // Csúcsfoglaló és felszabadító függvények
+  constexpr node *_new_node(const T &k, node *p);
+  constexpr void _free_node(node *x);
+  constexpr void _destroy(node *x);
 
   // Segédfüggvények
-  static node *_min(node *x);
-  static node *_max(node *x);
-  static node *_next(node *x);
-  static node *_prev(node *x);
+  constexpr node *_min(node *x) const;
+  constexpr node *_max(node *x) const;
+  constexpr node *_next(node *x) const;
+  constexpr node *_prev(node *x) const;
 
-  static size_t _size(node *x);
+  constexpr size_t _size(node *x) const;
 
   // Kiegyensúlyozásért felelős függvények
-  void _rotate_left(node *x);
-  void _rotate_right(node *x);
+  constexpr void _rotate_left(node *x);
+  constexpr void _rotate_right(node *x);
+
+  constexpr bool _rebalance_after_insert(node *x);
+  constexpr void _rebalance_after_remove(node *x);
+
+  // Kivágja z kulcsát a fából, és visszaadja a fizikailag kiláncolt csúcsot
+  constexpr node *_cut(node *z);
+
+  // Beszúrás y alá, illetve z törlése a kiegyensúlyozással és ellenőrzéssel
+  constexpr node *_insert_at(node *y, const T &k);
+  constexpr bool _erase(node *z);
+
+  // Ujjkeresés: x-ből felfelé lépve megkeresi a k-t lefedő részfát
+  constexpr node *_finger(node *x, const T &k, node *&cand) const;
+
+  // Vágás és összefűzés a tartományos törléshez
+  // Ezek a root adattagot munkaterületként használják.
+  // A fekete-magasságokat a hívó adja át, így nem kell újraszámolni őket.
+  struct split_result {
+    node *l;
+    size_t hl;
+    node *r;
+    size_t hr;
+  };
+  constexpr size_t _black_height(node *x) const;
+  constexpr node *_join(node *l, size_t hl, node *m, node *r, size_t hr, size_t &h);
+  constexpr node *_join(node *l, node *r);
+  template <class P> constexpr split_result _split(node *x, size_t hx, P goes_left);
 
-  void _rebalance_after_insert(node *x);
-  void _rebalance_after_remove(node *x);
+  // Rendezett csúcstömbből kiegyensúlyozott piros-fekete fát épít
+  constexpr node *_build(std::vector<node *> &nodes, size_t lo, size_t hi,
+                         size_t depth, size_t red_depth, node *parent);
 
   // Ellenőrző segédfüggvények
-  static size_t _validate(node *x);
+  constexpr size_t _validate(node *x) const;
+  constexpr void _check_node(node *x) const;
+  constexpr void _check_path(node *x) const;
 
 public:
   // Konstruktor és destruktor
-  rb_tree() : root(empty_leaf) {}
-  ~rb_tree() { _destroy(root); }
+  constexpr rb_tree() : root(empty_leaf) {}
+  constexpr ~rb_tree() {
+    _destroy(root);
+    shrink_to_fit();
+  }
 
   // Másoló konstruktor és operátor egyelőre nincs implementálva
   rb_tree(const rb_tree & /*t*/) { throw copy_not_implemented(); }
   rb_tree &operator=(const rb_tree & /*t*/) { throw copy_not_implemented(); }
 
   // Alapműveletek
-  [[nodiscard]] size_t size() const { return _size(root); }
+  [[nodiscard]] constexpr size_t size() const { return node_count; }
+
+  constexpr bool find(const T &k) const;
+  constexpr void insert(const T &k);
+  constexpr void remove(const T &k);
+
+  // Kurzor szekvenciális bejáráshoz és kereséshez.
+  // Megjegyzi az utolsó pozícióját, és onnan keres tovább (ujjkeresés).
+  // Monoton (csak növekvő vagy csak csökkenő) seek-sorozatra egy seek
+  // amortizált költsége O(log d), ahol d a régi és az új pozíció távolsága.
+  // Egyetlen seek a legrosszabb esetben d = 1 mellett is O(log n), ha a
+  // közös ősig a gyökérig kell felmászni (szintenkénti láncolás nincs).
+  // A fa nem a kurzoron keresztüli módosítása érvényteleníti a kurzort.
+  class cursor {
+    friend class rb_tree;
+
+    rb_tree *tree;
+    node *x;
+
+    constexpr cursor(rb_tree *t, node *n) : tree(t), x(n) {}
+
+  public:
+    // Igaz, ha a kurzor egy elemen áll (nem a fa végén)
+    [[nodiscard]] constexpr bool valid() const { return x != tree->empty_leaf; }
+    [[nodiscard]] constexpr const T &key() const {
+      assert(valid() && "Kurzor a fa vegen all");
+      return x->key;
+    }
+
+    constexpr bool seek(const T &k);
+    constexpr void next();
+    constexpr void prev();
+    constexpr void insert_here(const T &k);
+    constexpr void erase_here();
+  };
+
+  // A legkisebb elemre állított kurzort ad vissza
+  constexpr cursor make_cursor() {
+    return cursor(this, root == empty_leaf ? empty_leaf : _min(root));
+  }
+
+  // Tömeges törlés
+  constexpr void remove_range(const T &lo, const T &hi);
+  template <class P> constexpr void remove_if(P pred);
 
-  bool find(const T &k) const;
-  void insert(const T &k);
-  void remove(const T &k);
+  // Egy csúcs mérete bájtban (összehasonlításhoz az llrb_tree-vel)
+  static constexpr size_t node_size() { return sizeof(node); }
+
+  // Memóriahasználat bájtban, O(1) időben
+  struct memory_stats {
+    size_t nodes;    // élő csúcsok
+    size_t pooled;   // szabadlistán tartalékolt, újrahasznosítható csúcsok
+    size_t sentinel; // a fa saját empty_leaf csúcsa
+    [[nodiscard]] constexpr size_t total() const { return nodes + pooled + sentinel; }
+  };
+  [[nodiscard]] constexpr memory_stats memory_usage() const {
+    return {node_count * sizeof(node), pooled_count * sizeof(node), sizeof(node)};
+  }
+
+  // Bájtkeret: insert memory_budget_exceeded kivételt dob, ha új csúcs
+  // foglalásával az élő és tartalékolt csúcsok mérete túllépné. 0: nincs korlát.
+  constexpr void set_byte_budget(size_t bytes) { byte_budget = bytes; }
+  // Visszaadja a rendszernek a szabadlistán tartalékolt csúcsokat.
+  constexpr void shrink_to_fit();
 
   // Ellenőrző függvény
-  void validate() const;
+  constexpr void validate() const;
+
+  // Inkrementális ellenőrzés
+  // Bekapcsolva minden insert/remove után ellenőrzi a módosított utat,
+  // és a háttér-ellenőrzéssel legfeljebb budget további csúcsot.
+  constexpr void set_check_budget(size_t budget) { check_budget = budget; }
+  constexpr void validate_step(size_t budget) const;
 };
 
 //
 // Piros-fekete fa osztály
 // FÜGGVÉNYIMPLEMENTÁCIÓK
 //
-// Rekurzívan felszabadítja a csúcsokat.
+// Új csúcsot hoz létre, elsősorban a szabadlistáról.
+// Ha új foglalás kellene, és ezzel túllépnénk a bájtkeretet,
+// memory_budget_exceeded kivételt dob (a fa változatlan marad).
+// A csúcshelyeket std::allocator<node> foglalja, így a túligazított
+// T is a neki megfelelő operator new / delete párt kapja.
+template <class T> constexpr typename rb_tree<T>::node *rb_tree<T>::_new_node(const T &k, node *p) {
+  std::allocator<node> alloc;
+  node *x;
+  if (pool != nullptr) {
+    // Előbb létrehozzuk a csúcsot, és csak utána vesszük le a helyét a
+    // szabadlistáról: ha T másolása kivételt dob, a hely a listán marad.
+    free_block *b = pool;
+    free_block *next = b->next;
+    try {
+      x = std::construct_at(reinterpret_cast<node *>(b), k, p, empty_leaf);
+    } catch (...) {
+      ::new (static_cast<void *>(b)) free_block{next};
+      throw;
+    }
+    pool = next;
+    --pooled_count;
+  } else {
+    if (byte_budget != 0 &&
+        (node_count + pooled_count + 1) * sizeof(node) > byte_budget)
+      throw memory_budget_exceeded();
+    x = alloc.allocate(1);
+    try {
+      std::construct_at(x, k, p, empty_leaf);
+    } catch (...) {
+      alloc.deallocate(x, 1);
+      throw;
+    }
+  }
+  ++node_count;
+  return x;
+}
+
+// Lebontja az x csúcsot, helyét a szabadlistára teszi.
+// Fordítási idejű kiértékelésben nincs szabadlista (a hely más típusként
+// nem használható újra), ott a csúcs azonnal felszabadul.
+template <class T> constexpr void rb_tree<T>::_free_node(node *x) {
+  std::destroy_at(x);
+  --node_count;
+  if (std::is_constant_evaluated()) {
+    std::allocator<node>().deallocate(x, 1);
+    return;
+  }
+  pool = ::new (static_cast<void *>(x)) free_block{pool};
+  ++pooled_count;
+}
+
+// Rekurzívan felszabadítja a csúcsokat (a szabadlistára).
 // A destruktor hívja meg a gyökérre.
-template <class T> void rb_tree<T>::_destroy(node *x) {
+template <class T> constexpr void rb_tree<T>::_destroy(node *x) {
   if (x != empty_leaf) {
     _destroy(x->left);
     _destroy(x->right);
-    delete x;
+    _free_node(x);
+  }
+}
+
+// A szabadlistán tartalékolt csúcshelyeket visszaadja a rendszernek.
+template <class T> constexpr void rb_tree<T>::shrink_to_fit() {
+  while (pool != nullptr) {
+    free_block *b = pool;
+    pool = b->next;
+    std::allocator<node>().deallocate(reinterpret_cast<node *>(b), 1);
   }
+  pooled_count = 0;
 }
 
 // Visszaadja az x gyökerű részfa legkisebb értékű csúcsát.
 // Előfeltétel: x != empty_leaf
-template <class T> typename rb_tree<T>::node *rb_tree<T>::_min(node *x) {
+template <class T> constexpr typename rb_tree<T>::node *rb_tree<T>::_min(node *x) const {
   while (x->left != empty_leaf)
     x = x->left;
   return x;
@@ -104,7 +295,7 @@ template <class T> typename rb_tree<T>::node *rb_tree<T>::_min(node *x) {
 
 // Visszaadja az x gyökerű részfa legnagyobb értékű csúcsát.
 // Előfeltétel: x != empty_leaf
-template <class T> typename rb_tree<T>::node *rb_tree<T>::_max(node *x) {
+template <class T> constexpr typename rb_tree<T>::node *rb_tree<T>::_max(node *x) const {
   while (x->right != empty_leaf)
     x = x->right;
   return x;
@@ -113,7 +304,7 @@ template <class T> typename rb_tree<T>::node *rb_tree<T>::_max(node *x) {
 // Visszaadja a fából az x csúcs rákövetkezőjét,
 // vagy empty_leaf-t, ha x a legnagyobb kulcsú elem.
 // Előfeltétel: x != empty_leaf
-template <class T> typename rb_tree<T>::node *rb_tree<T>::_next(node *x) {
+template <class T> constexpr typename rb_tree<T>::node *rb_tree<T>::_next(node *x) const {
   if (x->right != empty_leaf)
     return _min(x->right);
 
@@ -128,7 +319,7 @@ template <class T> typename rb_tree<T>::node *rb_tree<T>::_next(node *x) {
 // Visszaadja a fából az x csúcs megelőzőjét,
 // vagy empty_leaf-t, ha x a legkisebb kulcsú elem.
 // Előfeltétel: x != empty_leaf
-template <class T> typename rb_tree<T>::node *rb_tree<T>::_prev(node *x) {
+template <class T> constexpr typename rb_tree<T>::node *rb_tree<T>::_prev(node *x) const {
   if (x->left != empty_leaf)
     return _max(x->left);
 
@@ -143,7 +334,7 @@ template <class T> typename rb_tree<T>::node *rb_tree<T>::_prev(node *x) {
 // Rekurzívan meghatározza, és visszaadja
 // az x gyökerű részfa elemeinek számát.
 // Megjegyzés: üres fára is működik -> 0-t ad vissza
-template <class T> size_t rb_tree<T>::_size(node *x) {
+template <class T> constexpr size_t rb_tree<T>::_size(node *x) const {
   if (x == empty_leaf)
     return 0;
   else
@@ -154,7 +345,7 @@ template <class T> size_t rb_tree<T>::_size(node *x) {
 // az x csúcs körül, illetve más szóhasználattal
 // az x csúcs és a jobb gyereke közötti él mentén.
 // Előfeltétel, hogy x létezik és a jobb gyereke nem empty_leaf.
-template <class T> void rb_tree<T>::_rotate_left(node *x) {
+template <class T> constexpr void rb_tree<T>::_rotate_left(node *x) {
   assert(nullptr != x && "Balra forgatas nullptr-en");
   assert(empty_leaf != x->right && "Balra forgatas nem letezo jobb gyerekkel");
   // y-nak nevezzük el x jobb gyerekét
@@ -187,7 +378,7 @@ template <class T> void rb_tree<T>::_rotate_left(node *x) {
 // az x csúcs körül, illetve más szóhasználattal
 // az x csúcs és a bal gyereke közötti él mentén.
 // Előfeltétel, hogy x létezik és a bal gyereke nem empty_leaf.
-template <class T> void rb_tree<T>::_rotate_right(node *x) {
+template <class T> constexpr void rb_tree<T>::_rotate_right(node *x) {
   assert(nullptr != x && "Jobbra forgatas nullptr-en");
   assert(empty_leaf != x->left && "Jobbra forgatas nem letezo bal gyerekkel");
   // y-nak nevezzük el x bal gyerekét
@@ -218,7 +409,9 @@ template <class T> void rb_tree<T>::_rotate_right(node *x) {
 
 // Beszúrás utáni kiegyensúlyozás
 // A beszúrt piros csúcsra kell meghívni
-template <class T> void rb_tree<T>::_rebalance_after_insert(node * x) {
+// Igazat ad vissza, ha a végén a gyökeret feketére kellett színezni,
+// vagyis a fa fekete-magassága eggyel nőtt.
+template <class T> constexpr bool rb_tree<T>::_rebalance_after_insert(node * x) {
   // x: problemas node - (piros szulo) piros gyermeke
   // u: x nagybacsija
   // p: szulo
@@ -234,7 +427,7 @@ template <class T> void rb_tree<T>::_rebalance_after_insert(node * x) {
 
   // A while ciklus minden egyes lefutasara egy adott szinten tortenik
   // a PF fa tulajdonsagok helyreallitasa.
-  while (x->parent->color != red) { //A gyoker szuloje fekete
+  while (x->parent->color == red) { //A gyoker szuloje fekete
       if (x->parent == x->parent->parent->left) {
           node * u = x->parent->parent->right;
 
@@ -293,13 +486,15 @@ template <class T> void rb_tree<T>::_rebalance_after_insert(node * x) {
           _rotate_left(x->parent->parent);
       }
   }
+  bool grew = root->color == red;
   root->color = black;
+  return grew;
 }
 
 // Törlés utáni utáni kiegyensúlyozás
 // A kivágott csúcs gyerekére kell meghívni, amely most
 // piros-fekete vagy kétszeresen fekete.
-template <class T> void rb_tree<T>::_rebalance_after_remove(node * x) {
+template <class T> constexpr void rb_tree<T>::_rebalance_after_remove(node * x) {
   // x: problemas node (DUPLA FEKETE)
   // w: x testvere
 
@@ -327,7 +522,7 @@ template <class T> void rb_tree<T>::_rebalance_after_remove(node * x) {
           //    -- kovetkezmeny : a duple fekete eggyel feljebb propagal,
           //                      ezen a szinten nincs tobb keresnivalonk
           //                      Elorol az egeszet a x->parent node-al.
-          if (w->left->color == w->right->color == black){
+          if (w->left->color == black && w->right->color == black){
               w->color = red;
 
               //tovaba x megszunik ketszeres feketetenek lenni,
@@ -339,24 +534,52 @@ template <class T> void rb_tree<T>::_rebalance_after_remove(node * x) {
 
           // 3. eset
           //    -- elofeltetel  : w FEKETE , w->left PIROS , w->right FEKETE
-          //    -- kovetkezmeny : w FEKETE , w->left ????? , w->right PIROS   (4. eset)
-          if (w->right == black){
-              w->right = red;
+          //    -- kovetkezmeny : w FEKETE , w->right PIROS   (4. eset)
+          if (w->right->color == black){
+              w->color = red;
               w->left->color = black;
               _rotate_right(w);
               w = x->parent->right;
           }
 
-          // 4. eset: w fekete, w->right
+          // 4. eset
           //    -- elofeltetel  : w FEKETE , w->right PIROS
           //    -- kovetkezmeny : a PF fa tulajdonsagai helyrealltak
-          if (w->color == black && w->right == red){
-              x->parent->color = w->left->color = black;
-              //kiegészytésre szorul
-          }
+          w->color = x->parent->color;
+          x->parent->color = w->right->color = black;
+          _rotate_left(x->parent);
+          x = root;
       } else{
-          node * w =( x->parent->left);
+          node * w = x->parent->left;
+
+          // 1. eset (tukorkepe)
+          if (w->color == red){
+              w->color = black;
+              x->parent->color = red;
+              _rotate_right(x->parent);
+              w = x->parent->left;
+          }
+
+          // 2. eset (tukorkepe)
+          if (w->left->color == black && w->right->color == black){
+              w->color = red;
+              x = x->parent;
+              continue;
+          }
+
+          // 3. eset (tukorkepe)
+          if (w->left->color == black){
+              w->color = red;
+              w->right->color = black;
+              _rotate_left(w);
+              w = x->parent->left;
+          }
 
+          // 4. eset (tukorkepe)
+          w->color = x->parent->color;
+          x->parent->color = w->left->color = black;
+          _rotate_right(x->parent);
+          x = root;
       }
   }
   x->color = black;
@@ -364,7 +587,7 @@ template <class T> void rb_tree<T>::_rebalance_after_remove(node * x) {
 
 // Lekérdezi, hogy található-e k kulcs a fában.
 // Igazat ad vissza, ha található.
-template <class T> bool rb_tree<T>::find(const T &k) const {
+template <class T> constexpr bool rb_tree<T>::find(const T &k) const {
   node *x = root;
   while (x != empty_leaf && k != x->key)
     if (k < x->key)
@@ -376,7 +599,7 @@ template <class T> bool rb_tree<T>::find(const T &k) const {
 
 // Beszúrja a k értéket a fába.
 // Ha már van k érték a fában, akkor nem csinál semmit.
-template <class T> void rb_tree<T>::insert(const T &k) {
+template <class T> constexpr void rb_tree<T>::insert(const T &k) {
   // Keresés
   node *y = empty_leaf;
   node *x = root;
@@ -392,8 +615,15 @@ template <class T> void rb_tree<T>::insert(const T &k) {
   if (x != empty_leaf)
     return;
 
+  _insert_at(y, k);
+}
+
+// Létrehozza és y gyerekeként beköti a k kulcsú csúcsot, majd kiegyensúlyoz.
+// Visszaadja az új csúcsot.
+// Előfeltétel: k nincs a fában, és y alatt a helye üres levél
+template <class T> constexpr typename rb_tree<T>::node *rb_tree<T>::_insert_at(node *y, const T &k) {
   // Új csúcs létrehozása és bekötése
-  node *z = new node(k, y);
+  node *z = _new_node(k, y);
   if (y == empty_leaf)
     root = z;
   else if (z->key < y->key)
@@ -403,11 +633,18 @@ template <class T> void rb_tree<T>::insert(const T &k) {
 
   // Beszúrás utáni kiegyensúlyozás
   _rebalance_after_insert(z);
+
+  // Inkrementális ellenőrzés
+  if (check_budget != 0) {
+    _check_path(z);
+    validate_step(check_budget);
+  }
+  return z;
 }
 
 // Eltávolítja a k értéket a fából.
 // Ha nem volt k érték a fában, akkor nem csinál semmit.
-template <class T> void rb_tree<T>::remove(const T &k) {
+template <class T> constexpr void rb_tree<T>::remove(const T &k) {
   // Keresés
   node *z = root;
   while (z != empty_leaf && k != z->key)
@@ -420,7 +657,126 @@ template <class T> void rb_tree<T>::remove(const T &k) {
   if (z == empty_leaf)
     return;
 
+  _erase(z);
+}
+
+// Törli a z csúcs kulcsát a fából, és felszabadítja a kiláncolt csúcsot.
+// Igazat ad vissza, ha z a fában maradt, és most a rákövetkező kulcsát
+// tartalmazza (kétgyerekes eset).
+template <class T> constexpr bool rb_tree<T>::_erase(node *z) {
   // Csúcs kivágása a fából és felszabadítás
+  node *y = _cut(z);
+  node *p = y->parent;
+  _free_node(y);
+
+  // Inkrementális ellenőrzés: a kivágott csúcs szülője a fában maradt
+  if (check_budget != 0) {
+    _check_path(p);
+    validate_step(check_budget);
+  }
+  return y != z;
+}
+
+// Ujjkeresés első fele: x-ből a szülőkön felfelé lépve megkeresi azt a
+// legkisebb y részfát, amelynek kulcstartományába k beleesik, így a keresés
+// innen folytatható lefelé. cand-ba kerül a k-nál nagyobb legközelebbi ős
+// (vagy empty_leaf), ha az y részfában nincs k-nál nem kisebb kulcs.
+// Ha x == empty_leaf, a gyökértől keres.
+// A felfelé lépések száma monoton keresési sorozaton amortizáltan
+// O(log d), egyetlen hívásban viszont legfeljebb O(log n).
+template <class T>
+constexpr typename rb_tree<T>::node *rb_tree<T>::_finger(node *x, const T &k, node *&cand) const {
+  cand = empty_leaf;
+  if (x == empty_leaf)
+    return root;
+
+  node *y = x;
+  if (x->key < k) {
+    // Előre: addig lépünk fel, amíg egy bal él felett k-nál nagyobb szülő nincs
+    while (y->parent != empty_leaf) {
+      node *p = y->parent;
+      if (y == p->left && k < p->key) {
+        cand = p;
+        break;
+      }
+      y = p;
+    }
+  } else if (k < x->key) {
+    // Hátra: addig lépünk fel, amíg egy jobb él felett k-nál kisebb szülő nincs
+    while (y->parent != empty_leaf) {
+      node *p = y->parent;
+      if (y == p->right && p->key < k)
+        break;
+      y = p;
+    }
+  }
+  return y;
+}
+
+// A kurzort az első k-nál nem kisebb kulcsra állítja (vagy a fa végére).
+// Igazat ad vissza, ha pontosan k-t találta meg.
+template <class T> constexpr bool rb_tree<T>::cursor::seek(const T &k) {
+  node *cand;
+  node *y = tree->_finger(x, k, cand);
+  while (y != tree->empty_leaf && k != y->key)
+    if (k < y->key) {
+      cand = y;
+      y = y->left;
+    } else {
+      y = y->right;
+    }
+
+  x = y != tree->empty_leaf ? y : cand;
+  return y != tree->empty_leaf;
+}
+
+// A következő elemre lép. A fa végéről nem lép tovább.
+template <class T> constexpr void rb_tree<T>::cursor::next() {
+  if (x != tree->empty_leaf)
+    x = tree->_next(x);
+}
+
+// Az előző elemre lép. A fa végéről a legnagyobb elemre lép.
+template <class T> constexpr void rb_tree<T>::cursor::prev() {
+  if (x != tree->empty_leaf)
+    x = tree->_prev(x);
+  else if (tree->root != tree->empty_leaf)
+    x = tree->_max(tree->root);
+}
+
+// Beszúrja k-t a kurzor közelében kezdett ujjkereséssel,
+// és a kurzort a k kulcsú elemre állítja.
+template <class T> constexpr void rb_tree<T>::cursor::insert_here(const T &k) {
+  node *cand;
+  node *y = tree->_finger(x, k, cand);
+  node *p = tree->empty_leaf;
+  while (y != tree->empty_leaf && k != y->key) {
+    p = y;
+    if (k < y->key)
+      y = y->left;
+    else
+      y = y->right;
+  }
+
+  x = y != tree->empty_leaf ? y : tree->_insert_at(p, k);
+}
+
+// Törli a kurzor alatti elemet, és a kurzort a rákövetkezőjére állítja.
+template <class T> constexpr void rb_tree<T>::cursor::erase_here() {
+  if (x == tree->empty_leaf)
+    return;
+
+  node *n = tree->_next(x);
+  if (!tree->_erase(x))
+    x = n;
+}
+
+// Kivágja a z csúcs kulcsát a fából, és elvégzi a törlés utáni
+// kiegyensúlyozást. Visszaadja a ténylegesen kiláncolt csúcsot, amelyet a
+// hívónak kell felszabadítania. Ha z-nek legfeljebb egy gyereke van, akkor
+// ez maga z, kulcsa érintetlen.
+// Előfeltétel: z != empty_leaf
+template <class T> constexpr typename rb_tree<T>::node *rb_tree<T>::_cut(node *z) {
   node *y;
   if (z->left == empty_leaf || z->right == empty_leaf)
     y = z;
@@ -445,18 +801,212 @@ template <class T> void rb_tree<T>::remove(const T &k) {
   if (y != z)
     z->key = y->key;
 
-  bool y_black = y->color == black;
-  delete y;
-
   // Törlés utáni kiegyensúlyozás
-  if (y_black)
+  if (y->color == black)
     _rebalance_after_remove(x);
+
+  return y;
+}
+
+// Visszaadja az x gyökerű részfa fekete-magasságát a bal szélső út mentén.
+// Érvényes piros-fekete részfára ez bármely útra ugyanannyi.
+template <class T> constexpr size_t rb_tree<T>::_black_height(node *x) const {
+  size_t h = 0;
+  for (; x != empty_leaf; x = x->left)
+    h += x->color == black;
+  return h;
+}
+
+// Összefűzi az l és r gyökerű fákat az m csúcs köré, ahol
+// l minden kulcsa < m->key < r minden kulcsa, hl és hr pedig a két fa
+// fekete-magassága (a gyökereket is beleszámolva).
+// A magasabb fa gerincén lefelé haladva megkeresi azt a fekete csúcsot,
+// amelynek fekete-magassága megegyezik az alacsonyabb fáéval, oda köti be
+// a piros m-et, majd a beszúrás utáni kiegyensúlyozással javít.
+// Költsége O(|hl - hr| + 1), visszaadja az új gyökeret, h-ba pedig
+// az összefűzött fa fekete-magasságát írja.
+template <class T>
+constexpr typename rb_tree<T>::node *rb_tree<T>::_join(node *l, size_t hl, node *m,
+                                             node *r, size_t hr, size_t &h) {
+  // A részfák gyökerei feketék lesznek, szülő nélkül
+  if (l != empty_leaf) {
+    hl += l->color == red;
+    l->color = black;
+    l->parent = empty_leaf;
+  }
+  if (r != empty_leaf) {
+    hr += r->color == red;
+    r->color = black;
+    r->parent = empty_leaf;
+  }
+  h = hl >= hr ? hl : hr;
+
+  m->color = red;
+  node *p = empty_leaf;
+  node *c;
+  if (hl >= hr) {
+    // l jobb gerincén lefelé, m jobb gyereke r lesz
+    root = l;
+    c = l;
+    while (c->color != black || hl != hr) {
+      hl -= c->color == black;
+      p = c;
+      c = c->right;
+    }
+    if (p != empty_leaf)
+      p->right = m;
+    m->left = c;
+    m->right = r;
+  } else {
+    // r bal gerincén lefelé, m bal gyereke l lesz
+    root = r;
+    c = r;
+    while (c->color != black || hr != hl) {
+      hr -= c->color == black;
+      p = c;
+      c = c->left;
+    }
+    if (p != empty_leaf)
+      p->left = m;
+    m->left = l;
+    m->right = c;
+  }
+
+  // m bekötése c helyére
+  m->parent = p;
+  if (p == empty_leaf)
+    root = m;
+  if (m->left != empty_leaf)
+    m->left->parent = m;
+  if (m->right != empty_leaf)
+    m->right->parent = m;
+
+  h += _rebalance_after_insert(m);
+  return root;
+}
+
+// Összefűzi az l és r gyökerű fákat, ahol l minden kulcsa < r minden kulcsa.
+// Az l legnagyobb csúcsát kivágja, és azt használja összekötő csúcsként.
+// A fekete-magasságokat egyszer, a kivágás után számolja: O(log n).
+template <class T>
+constexpr typename rb_tree<T>::node *rb_tree<T>::_join(node *l, node *r) {
+  if (l == empty_leaf) {
+    if (r != empty_leaf) {
+      r->color = black;
+      r->parent = empty_leaf;
+    }
+    return r;
+  }
+
+  root = l;
+  l->parent = empty_leaf;
+  node *m = _cut(_max(l));
+  size_t h;
+  return _join(root, _black_height(root), m, r, _black_height(r), h);
+}
+
+// Kettévágja az x gyökerű, hx fekete-magasságú fát: az első fába kerülnek
+// azok a kulcsok, amelyekre goes_left igaz, a másodikba a többi. goes_left
+// monoton kell legyen (egy prefixre igaz). A keresési út mentén haladva a
+// leváló részfákat _join-nal fűzi össze. A fekete-magasságokat lefelé
+// továbbadja, így az összefűzések költsége teleszkópikusan O(log n).
+template <class T>
+template <class P>
+constexpr typename rb_tree<T>::split_result rb_tree<T>::_split(node *x, size_t hx,
+                                                     P goes_left) {
+  if (x == empty_leaf)
+    return {empty_leaf, 0, empty_leaf, 0};
+
+  // A gyerekek fekete-magassága
+  size_t hc = hx - (x->color == black);
+  node *l = x->left;
+  node *r = x->right;
+  x->left = x->right = empty_leaf;
+
+  size_t h;
+  if (goes_left(x->key)) {
+    split_result s = _split(r, hc, goes_left);
+    node *j = _join(l, hc, x, s.l, s.hl, h);
+    return {j, h, s.r, s.hr};
+  }
+  split_result s = _split(l, hc, goes_left);
+  node *j = _join(s.r, s.hr, x, r, hc, h);
+  return {s.l, s.hl, j, h};
+}
+
+// Eltávolítja a fából a [lo, hi] zárt intervallumba eső kulcsokat.
+// A tartományt egy részfaként vágja ki és szabadítja fel, kiegyensúlyozás
+// csak a két határ menti úton történik: O(log n + k).
+template <class T> constexpr void rb_tree<T>::remove_range(const T &lo, const T &hi) {
+  if (hi < lo || root == empty_leaf)
+    return;
+
+  split_result a = _split(root, _black_height(root),
+                          [&](const T &k) { return k < lo; });
+  split_result b = _split(a.r, a.hr, [&](const T &k) { return !(hi < k); });
+  _destroy(b.l);
+  root = _join(a.l, b.r);
+  root->color = black;
+
+  if (check_budget != 0)
+    validate_step(check_budget);
+}
+
+// Eltávolítja a fából azokat a kulcsokat, amelyekre pred igaz.
+// Egyetlen inorder bejárással gyűjti a megmaradó csúcsokat, és
+// egyenként kiegyensúlyozás helyett O(n) időben újraépíti a fát.
+template <class T> template <class P> constexpr void rb_tree<T>::remove_if(P pred) {
+  // Előbb szétválogatjuk a csúcsokat, és csak utána szabadítunk fel:
+  // _next a szülőkön át lép tovább, és ha pred kivételt dob, a fa
+  // érintetlen marad.
+  std::vector<node *> keep, drop;
+  if (root != empty_leaf) {
+    for (node *x = _min(root); x != empty_leaf; x = _next(x)) {
+      if (pred(x->key))
+        drop.push_back(x);
+      else
+        keep.push_back(x);
+    }
+  }
+
+  for (node *x : drop)
+    _free_node(x);
+
+  // A legalsó szint csúcsai pirosak, így minden út fekete-magassága egyenlő
+  size_t red_depth = 0;
+  while ((size_t{2} << red_depth) <= keep.size())
+    ++red_depth;
+
+  root = _build(keep, 0, keep.size(), 0, red_depth, empty_leaf);
+  root->color = black;
+
+  if (check_budget != 0)
+    validate_step(check_budget);
+}
+
+// Rekurzívan felépíti a nodes[lo, hi) csúcsokból álló kiegyensúlyozott fát.
+// A red_depth mélységű csúcsok pirosak, a többiek feketék.
+template <class T>
+constexpr typename rb_tree<T>::node *rb_tree<T>::_build(std::vector<node *> &nodes,
+                                              size_t lo, size_t hi,
+                                              size_t depth, size_t red_depth,
+                                              node *parent) {
+  if (lo == hi)
+    return empty_leaf;
+
+  size_t mid = lo + (hi - lo) / 2;
+  node *x = nodes[mid];
+  x->parent = parent;
+  x->color = depth == red_depth && depth > 0 ? red : black;
+  x->left = _build(nodes, lo, mid, depth + 1, red_depth, x);
+  x->right = _build(nodes, mid + 1, hi, depth + 1, red_depth, x);
+  return x;
 }
 
 // Rekurzív segédfüggvény a piros-fekete tulajdonságok ellenőrzéséhez
 // Paraméterül kapja az ellenőrizendő részfa gyökerét, és visszaadja
 // a részfa fekete-magasságát.
-template <class T> size_t rb_tree<T>::_validate(node *x) {
+template <class T> constexpr size_t rb_tree<T>::_validate(node *x) const {
   // empty_leaf fekete-magassága nulla
   if (x == empty_leaf)
     return 0;
@@ -488,7 +1038,7 @@ template <class T> size_t rb_tree<T>::_validate(node *x) {
 // Ez a függvény a debugolást segíti.
 // Ellenőrzi, hogy a gyökérből elérhető fa érvényes
 // bináris keresőfa, illetve érvényes piros-fekete fa-e.
-template <class T> void rb_tree<T>::validate() const {
+template <class T> constexpr void rb_tree<T>::validate() const {
   // Keresőfa tulajdonság ellenőrzése bejárással
   if (root != empty_leaf) {
     node *x = _min(root);
@@ -516,6 +1066,125 @@ template <class T> void rb_tree<T>::validate() const {
 
   // A fa rekurzív ellenőrzése
   _validate(root);
+
+  // A nyilvántartott elemszám egyezik-e a fában lévő csúcsok számával
+  if (node_count != _size(root))
+    throw invalid_rb_tree("Hibas csucsszamlalo.");
+}
+
+// Egyetlen csúcs lokális ellenőrzése: szülő-gyerek kapcsolatok,
+// keresőfa tulajdonság a gyerekekkel, piros-piros él.
+// Előfeltétel: x != empty_leaf
+template <class T> constexpr void rb_tree<T>::_check_node(node *x) const {
+  if (x->color != red && x->color != black)
+    throw invalid_rb_tree("Se nem piros, s nem fekete!");
+
+  if (x->left != empty_leaf) {
+    if (x->left->parent != x)
+      throw invalid_rb_tree("Hibas szulo pointer.");
+    if (!(x->left->key < x->key))
+      throw invalid_binary_search_tree();
+    if (x->color == red && x->left->color == red)
+      throw invalid_rb_tree("Piros csucsnak piros gyereke van.");
+  }
+  if (x->right != empty_leaf) {
+    if (x->right->parent != x)
+      throw invalid_rb_tree("Hibas szulo pointer.");
+    if (!(x->key < x->right->key))
+      throw invalid_binary_search_tree();
+    if (x->color == red && x->right->color == red)
+      throw invalid_rb_tree("Piros csucsnak piros gyereke van.");
+  }
+}
+
+// Ellenőrzi az x-től a gyökérig vezető utat, ahol egy módosítás történt.
+// Minden csúcsnál lokális ellenőrzés, és a két gyerek fekete-magasságának
+// összevetése a bal szélső utak mentén: O(log^2 n).
+template <class T> constexpr void rb_tree<T>::_check_path(node *x) const {
+  if (root->color != black)
+    throw invalid_rb_tree("gyoker nem fekete!");
+
+  for (; x != empty_leaf; x = x->parent) {
+    _check_node(x);
+    if (_black_height(x->left) != _black_height(x->right))
+      throw invalid_rb_tree("A fekete magassag kulonbozik a ket oldalon.");
+    if (x->parent == empty_leaf && x != root)
+      throw invalid_rb_tree("Hibas szulo pointer.");
+  }
+}
+
+// Háttér-ellenőrzés: a legutóbb ellenőrzött kulcs után folytatva
+// legfeljebb budget csúcsot vizsgál inorder sorrendben, a fa végére érve
+// elölről kezdi. Egy teljes kör a validate()-tel egyenértékű ellenőrzést ad,
+// hívásonként O(budget * log n) költséggel.
+template <class T> constexpr void rb_tree<T>::validate_step(size_t budget) const {
+  if (root == empty_leaf) {
+    sweep_started = false;
+    return;
+  }
+
+  // Az első sweep_key-nél nagyobb kulcsú csúcs megkeresése
+  node *x;
+  if (!sweep_started) {
+    x = _min(root);
+  } else {
+    x = empty_leaf;
+    for (node *y = root; y != empty_leaf;)
+      if (sweep_key < y->key) {
+        x = y;
+        y = y->left;
+      } else {
+        y = y->right;
+      }
+  }
+
+  size_t black_height = _black_height(root);
+  for (; budget != 0 && x != empty_leaf; --budget) {
+    _check_node(x);
+
+    // Levél melletti csúcsnál a gyökérig vezető út fekete-magassága
+    if (x->left == empty_leaf || x->right == empty_leaf) {
+      size_t h = 0;
+      for (node *y = x; y != empty_leaf; y = y->parent)
+        h += y->color == black;
+      if (h != black_height)
+        throw invalid_rb_tree("A fekete magassag kulonbozik a ket oldalon.");
+    }
+
+    node *next = _next(x);
+    if (next != empty_leaf && !(x->key < next->key))
+      throw invalid_binary_search_tree();
+
+    sweep_key = x->key;
+    sweep_started = true;
+    x = next;
+  }
+
+  // A fa végére értünk, a következő hívás elölről kezdi
+  if (x == empty_leaf)
+    sweep_started = false;
+}
+
+// Fordítási időben felépített fát rendezett std::array-be fagyaszt.
+// A build(rb_tree<T> &) constexpr függvény tölti fel a fát; a kapott
+// tömbben std::binary_search-csel lehet keresni, futásidejű építés nélkül.
+// Használat:
+//   constexpr void build(rb_tree<int> &t) { t.insert(...); ... }
+//   constexpr auto table = freeze_to_array<int, build>();
+template <class T, auto build> consteval auto freeze_to_array() {
+  constexpr size_t n = [] {
+    rb_tree<T> t;
+    build(t);
+    return t.size();
+  }();
+
+  std::array<T, n> sorted{};
+  rb_tree<T> t;
+  build(t);
+  size_t i = 0;
+  for (auto c = t.make_cursor(); c.valid(); c.next())
+    sorted[i++] = c.key();
+  return sorted;
 }
 
 #endif // RB_TREE_HPP_INCLUDED
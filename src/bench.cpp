@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "llrb_tree.hpp"
+#include "rb_tree.hpp"
+
+using namespace std;
+
+// Ennyi véletlen kulccsal mérünk
+constexpr int N = 1000000;
+
+/**
+ * @brief Lemeri egy fa tipus beszuras, kereses es torles idejet ugyanarra a
+ * kulcssorozatra, es kiirja a csucsok altal foglalt memoriat.
+ */
+template <class Tree> void bench(const char *name, const vector<int> &keys) {
+  using clock = chrono::steady_clock;
+  auto ms = [](clock::duration d) {
+    return chrono::duration_cast<chrono::milliseconds>(d).count();
+  };
+
+  Tree t;
+  auto t0 = clock::now();
+  for (int k : keys)
+    t.insert(k);
+  auto t1 = clock::now();
+  size_t found = 0;
+  for (int k : keys)
+    found += t.find(k);
+  auto t2 = clock::now();
+  size_t n = t.size();
+  for (int k : keys)
+    t.remove(k);
+  auto t3 = clock::now();
+
+  cout << name << ": csucsmeret " << Tree::node_size() << " B, " << n
+       << " csucs ~" << n * Tree::node_size() / 1024 << " KiB | beszuras "
+       << ms(t1 - t0) << " ms, kereses " << ms(t2 - t1) << " ms (" << found
+       << "), torles " << ms(t3 - t2) << " ms" << endl;
+}
+
+/**
+ * @brief Novekvo kulcssorozat lekerdezese: minden kereses a gyokertol
+ * indul (find), illetve egy kurzor ujjkeresessel folytatja az elozo
+ * poziciotol (seek). Viszonyitasi alapnak egy teljes inorder bejaras
+ * (next) idejet is kiirja, ennel gyorsabb sorrendi lekerdezes nem varhato.
+ */
+void bench_sequential(const vector<int> &keys) {
+  using clock = chrono::steady_clock;
+  auto ms = [](clock::duration d) {
+    return chrono::duration_cast<chrono::milliseconds>(d).count();
+  };
+
+  rb_tree<int> t;
+  for (int k : keys)
+    t.insert(k);
+  vector<int> probes(keys);
+  sort(probes.begin(), probes.end());
+
+  auto t0 = clock::now();
+  size_t found = 0;
+  for (int k : probes)
+    found += t.find(k);
+  auto t1 = clock::now();
+  auto c = t.make_cursor();
+  size_t sought = 0;
+  for (int k : probes)
+    sought += c.seek(k);
+  auto t2 = clock::now();
+  size_t walked = 0;
+  for (auto w = t.make_cursor(); w.valid(); w.next())
+    walked += w.key() != 0;
+  auto t3 = clock::now();
+
+  cout << "rb_tree novekvo kereses: find " << ms(t1 - t0) << " ms (" << found
+       << "), kurzor seek " << ms(t2 - t1) << " ms (" << sought
+       << "), inorder bejaras " << ms(t3 - t2) << " ms (" << walked << ")"
+       << endl;
+}
+
+int main() {
+  mt19937 g(42);
+  uniform_int_distribution<int> dist(0, numeric_limits<int>::max());
+  vector<int> keys(N);
+  for (int &k : keys)
+    k = dist(g);
+
+  bench<rb_tree<int>>("rb_tree   (alulrol felfele)", keys);
+  bench<llrb_tree<int>>("llrb_tree (balra dolo)    ", keys);
+  bench_sequential(keys);
+  return 0;
+}
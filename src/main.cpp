@@ -6,6 +6,7 @@
 #include <set>
 #include <vector>
 
+#include "llrb_tree.hpp"
 #include "rb_tree.hpp"
 
 using namespace std;
@@ -15,6 +16,12 @@ void test_insert();
 void test_remove();
 void small_random_test();
 void big_random_test();
+void llrb_random_test();
+void test_bulk_remove();
+void test_check_budget();
+void test_memory_budget();
+void test_cursor();
+void test_constexpr_tree();
 
 int main() {
   try {
@@ -24,10 +31,23 @@ int main() {
     cout << "\n*** Remove tesztek ***\n";
     test_remove();
     cout << "\n*** Remove tesztek sikeresek ***\n";
+    cout << "\n*** Tomeges torles tesztek ***\n" << endl;
+    test_bulk_remove();
+    cout << "\n*** Tomeges torles tesztek sikeresek ***\n";
     cout << "\n*** Kis elemszamu, reszletes teszt futtatasa ***\n" << endl;
     small_random_test();
+    cout << "\n*** Inkrementalis ellenorzes teszt ***\n" << endl;
+    test_check_budget();
+    cout << "\n*** Memoriakeret teszt ***\n" << endl;
+    test_memory_budget();
+    cout << "\n*** Kurzor teszt ***\n" << endl;
+    test_cursor();
     cout << "\n*** Nagy elemszamu teszt futtatasa ***\n" << endl;
     big_random_test();
+    cout << "\n*** Balra dolo PF fa teszt futtatasa ***\n" << endl;
+    llrb_random_test();
+    cout << "\n*** Forditasi ideju fa teszt ***\n" << endl;
+    test_constexpr_tree();
   } catch (const exception &e) {
     cout << "HIBA: " << e.what() << endl;
     return 1;
@@ -123,6 +143,69 @@ void test_remove() {
   }
 }
 
+/**
+ * @brief A remove_range es remove_if tomeges torleseket teszteli. Veletlen
+ * tartomanyokat torlunk a fabol es egy std::set-bol is, minden lepes utan
+ * validate-el ellenorizzuk a PF fa tulajdonsagokat, es osszevetjuk a
+ * ket adatszerkezetet.
+ */
+void test_bulk_remove() {
+  mt19937 g(12345);
+  uniform_int_distribution<int> dist(0, 5000);
+  set<int> stdSet;
+  rb_tree<int> tree;
+  for (int i = 0; i < 2000; i++) {
+    int x = dist(g);
+    stdSet.insert(x);
+    tree.insert(x);
+  }
+
+  for (int i = 0; i < 50; i++) {
+    int lo = dist(g), hi = lo + dist(g) / 20;
+    tree.remove_range(lo, hi);
+    stdSet.erase(stdSet.lower_bound(lo), stdSet.upper_bound(hi));
+    tree.validate();
+    assert(tree.size() == stdSet.size() && "Meret nem egyezik!");
+    for (int j = lo - 5; j <= hi + 5; j++)
+      assert(tree.find(j) == (stdSet.count(j) == 1) && "Hibas remove_range!");
+
+    // Vissza is toltunk nehany elemet, hogy a fa ne uruljon ki
+    for (int j = 0; j < 20; j++) {
+      int x = dist(g);
+      stdSet.insert(x);
+      tree.insert(x);
+    }
+  }
+  cout << "remove_range ok." << endl;
+
+  // Ha a predikatum kivetelt dob, a fa valtozatlan marad
+  try {
+    tree.remove_if([](int k) {
+      if (k > 2500)
+        throw invalid_binary_search_tree();
+      return k % 2 == 0;
+    });
+  } catch (const invalid_binary_search_tree &) {
+  }
+  tree.validate();
+  assert(tree.size() == stdSet.size() && "remove_if kivetel utan valtozott a fa!");
+
+  tree.remove_if([](int k) { return k % 3 == 0; });
+  erase_if(stdSet, [](int k) { return k % 3 == 0; });
+  tree.validate();
+  assert(tree.size() == stdSet.size() && "Meret nem egyezik!");
+  assert(all_of(stdSet.begin(), stdSet.end(), [&](int x) { return tree.find(x); }) &&
+         "Hianyzo elem remove_if utan!");
+  tree.insert(3);
+  tree.remove(3);
+  tree.validate();
+
+  tree.remove_range(numeric_limits<int>::min(), numeric_limits<int>::max());
+  tree.validate();
+  assert(tree.size() == 0 && "A teljes tartomany torlese utan uresnek kene lennie.");
+  cout << "remove_if ok." << endl;
+}
+
 /**
  * @brief Futtatunk egy tesztet, amely 1000 véletlen számot szúr be a
  * piros-fekete fánkba. Minden egyes beszúrás után ellenőrizzük, hogy az
@@ -179,6 +262,177 @@ void small_random_test() {
   cout << "\nMeret rendben.\n" << endl;
 }
 
+/**
+ * @brief Bekapcsolt inkrementalis ellenorzessel (set_check_budget) futtat
+ * veletlen beszurasokat es torleseket. Minden muvelet utan a fa maga
+ * ellenorzi a modositott utat es egy szeletet a fabol; a vegen egy teljes
+ * validate() is lefut.
+ */
+void test_check_budget() {
+  mt19937 g(2024);
+  uniform_int_distribution<int> dist(0, 20000);
+  rb_tree<int> tree;
+  tree.set_check_budget(8);
+  for (int i = 0; i < 10000; i++) {
+    int x = dist(g);
+    if (i % 3 == 2)
+      tree.remove(x);
+    else
+      tree.insert(x);
+  }
+  tree.validate();
+
+  // A halmozott lepesek egy teljes kort is lefednek
+  for (int i = 0; i < 2000; i++)
+    tree.validate_step(4);
+  cout << "Inkrementalis ellenorzes ok." << endl;
+}
+
+// Tuligazitott tesztkulcs, amelynek masolasa keresre kivetelt dob
+struct alignas(64) fragile_key {
+  static inline bool fail = false;
+  int value = 0;
+
+  fragile_key() = default;
+  explicit fragile_key(int v) : value(v) {}
+  fragile_key(const fragile_key &o) : value(o.value) {
+    if (fail)
+      throw copy_not_implemented();
+  }
+  fragile_key &operator=(const fragile_key &) = default;
+
+  bool operator<(const fragile_key &o) const { return value < o.value; }
+  bool operator!=(const fragile_key &o) const { return value != o.value; }
+};
+
+/**
+ * @brief A memory_usage nyilvantartast es a bajtkeretet teszteli. A keret
+ * elereseig beszurunk, ellenorizzuk, hogy a kovetkezo beszuras kivetelt dob
+ * es a fa valtozatlan marad, majd hogy torles utan a tartalekolt csucsok
+ * ujrahasznosulnak, es shrink_to_fit visszaadja oket.
+ */
+void test_memory_budget() {
+  rb_tree<int> tree;
+  const size_t node = rb_tree<int>::node_size();
+  tree.set_byte_budget(100 * node);
+  for (int i = 0; i < 100; i++)
+    tree.insert(i);
+  assert(tree.memory_usage().nodes == 100 * node && "Hibas memoriaszamitas!");
+
+  [[maybe_unused]] bool thrown = false;
+  try {
+    tree.insert(100);
+  } catch (const memory_budget_exceeded &) {
+    thrown = true;
+  }
+  assert(thrown && "A keret tullepesekor kivetelt kellett volna dobni!");
+  assert(tree.size() == 100 && !tree.find(100) && "A fa nem maradt valtozatlan!");
+  tree.validate();
+
+  // Torles utan a csucsok a szabadlistara kerulnek, es ujra felhasznalhatok
+  tree.remove_range(0, 9);
+  assert(tree.memory_usage().nodes == 90 * node &&
+         tree.memory_usage().pooled == 10 * node && "Hibas memoriaszamitas!");
+  for (int i = 100; i < 110; i++)
+    tree.insert(i);
+  assert(tree.memory_usage().pooled == 0 && "A tartalek csucsok nem hasznalodtak!");
+
+  tree.remove(50);
+  tree.shrink_to_fit();
+  assert(tree.memory_usage().pooled == 0 && tree.size() == 99 &&
+         "shrink_to_fit utan nem maradhat tartalek!");
+  tree.validate();
+
+  // Tuligazitott kulcs, amelynek masolasa kivetelt dobhat: a szabadlistarol
+  // vett hely kivetel eseten nem veszhet el
+  rb_tree<fragile_key> fragile;
+  for (int i = 0; i < 10; i++)
+    fragile.insert(fragile_key{i});
+  fragile.remove(fragile_key{3});
+  fragile_key::fail = true;
+  try {
+    fragile.insert(fragile_key{42});
+  } catch (const copy_not_implemented &) {
+  }
+  fragile_key::fail = false;
+  assert(fragile.size() == 9 && fragile.memory_usage().pooled == rb_tree<fragile_key>::node_size() &&
+         "A szabadlista helye elveszett!");
+  fragile.insert(fragile_key{42});
+  fragile.validate();
+  fragile.shrink_to_fit();
+  cout << "Memoriakeret ok." << endl;
+}
+
+/**
+ * @brief A kurzort (ujjkeresest) teszteli egy std::set-tel osszevetve:
+ * novekvo es csokkeno seek-ek, next/prev lepkedes, valamint a kurzoron
+ * keresztuli beszuras es torles, utana validate-el ellenorizve.
+ */
+void test_cursor() {
+  mt19937 g(777);
+  uniform_int_distribution<int> dist(0, 20000);
+  set<int> stdSet;
+  rb_tree<int> tree;
+  for (int i = 0; i < 3000; i++) {
+    int x = dist(g);
+    stdSet.insert(x);
+    tree.insert(x);
+  }
+
+  auto c = tree.make_cursor();
+  assert(c.valid() && c.key() == *stdSet.begin() && "Hibas kezdopozicio!");
+
+  // Novekvo, majd veletlen iranyu keresesek
+  vector<int> probes;
+  for (int i = 0; i < 2000; i++)
+    probes.push_back(dist(g));
+  sort(probes.begin(), probes.end());
+  for (int i = 0; i < 1000; i++)
+    probes.push_back(dist(g));
+  for (int k : probes) {
+    [[maybe_unused]] auto it = stdSet.lower_bound(k);
+    [[maybe_unused]] bool found = c.seek(k);
+    assert(found == (it != stdSet.end() && *it == k) && "Hibas seek!");
+    assert(c.valid() == (it != stdSet.end()) && "Hibas seek pozicio!");
+    if (c.valid())
+      assert(c.key() == *it && "Hibas seek pozicio!");
+  }
+
+  // Bejaras next-tel es prev-vel
+  c = tree.make_cursor();
+  for ([[maybe_unused]] int x : stdSet) {
+    assert(c.valid() && c.key() == x && "Hibas next!");
+    c.next();
+  }
+  assert(!c.valid() && "A bejaras vegen a fa vegen kell allni!");
+  for (auto it = stdSet.rbegin(); it != stdSet.rend(); it++) {
+    c.prev();
+    assert(c.valid() && c.key() == *it && "Hibas prev!");
+  }
+
+  // Beszuras es torles a kurzoron keresztul
+  for (int i = 0; i < 2000; i++) {
+    int x = dist(g);
+    if (i % 2 == 0) {
+      c.insert_here(x);
+      stdSet.insert(x);
+      assert(c.valid() && c.key() == x && "Hibas insert_here!");
+    } else {
+      c.seek(x);
+      if (!c.valid())
+        continue;
+      [[maybe_unused]] auto it = stdSet.erase(stdSet.find(c.key()));
+      c.erase_here();
+      assert(c.valid() == (it != stdSet.end()) && "Hibas erase_here!");
+      if (c.valid())
+        assert(c.key() == *it && "Hibas erase_here!");
+    }
+  }
+  tree.validate();
+  assert(tree.size() == stdSet.size() && "Meret nem egyezik!");
+  cout << "Kurzor ok." << endl;
+}
+
 /**
  * @brief Most egymillió véletlen számot szúrunk be a piros-fekete fába, és
  * párhuzamosan egy std::set-be. Csak a végén ellenőrizzük, hogy érvényes-e
@@ -223,3 +477,78 @@ void big_random_test() {
          "Meret nem egyezik! Minden elem eltavolitasa utan 0-nak kene lennie.");
   cout << " ok." << endl;
 }
+
+/**
+ * @brief A balra dolo (szulo pointer nelkuli) piros-fekete fat teszteli.
+ * Veletlen szamokat szurunk be es torlunk, minden lepes utan validate-el
+ * ellenorizzuk, es a vegen osszevetjuk a bejarast az std::set tartalmaval.
+ */
+void llrb_random_test() {
+  random_device rd;
+  mt19937 g(rd());
+  uniform_int_distribution<int> dist(0, 10000);
+  set<int> stdShort;
+  llrb_tree<int> myShort;
+  for (int i = 0; i < 1000; i++) {
+    int x = dist(g);
+    stdShort.insert(x);
+    myShort.insert(x);
+    myShort.validate();
+  }
+
+  vector<int> inorder;
+  myShort.for_each([&](int k) { inorder.push_back(k); });
+  assert(equal(inorder.begin(), inorder.end(), stdShort.begin(), stdShort.end()) &&
+         "Bejaras nem egyezik!");
+  cout << "Beszuras ok." << endl;
+
+  vector<int> arrayShort(stdShort.begin(), stdShort.end());
+  shuffle(arrayShort.begin(), arrayShort.end(), g);
+  for (int x : arrayShort) {
+    myShort.remove(x);
+    myShort.remove(x);
+    myShort.validate();
+  }
+  assert(myShort.size() == 0 &&
+         "Meret nem egyezik! Minden elem eltavolitasa utan 0-nak kene lennie.");
+  cout << "Torles ok." << endl;
+}
+
+// Forditasi idoben futtathato tablaepito fuggveny a constexpr teszthez
+template <class Tree> constexpr void build_table(Tree &t) {
+  for (int k : {50, 20, 80, 10, 30, 70, 90, 60, 40, 20})
+    t.insert(k);
+  t.remove(90);
+  t.validate();
+}
+
+/**
+ * @brief A piros-fekete fat (es a balra dolo valtozatot) forditasi idoben
+ * epitjuk fel es kerdezzuk le, majd rendezett tombbe fagyasztjuk. Az
+ * ellenorzesek static_assert-ek, igy mar a forditas elbukik, ha valami nem
+ * konstans kifejezes.
+ */
+void test_constexpr_tree() {
+  static_assert([] {
+    rb_tree<int> t;
+    build_table(t);
+    t.remove_range(25, 45);
+    auto c = t.make_cursor();
+    c.seek(25);
+    return t.size() == 6 && t.find(60) && !t.find(90) && !t.find(30) &&
+           c.valid() && c.key() == 50;
+  }());
+
+  static_assert([] {
+    llrb_tree<int> t;
+    build_table(t);
+    return t.size() == 8 && t.find(60) && !t.find(90) && !t.find(55);
+  }());
+
+  constexpr auto table = freeze_to_array<int, build_table<rb_tree<int>>>();
+  static_assert(table.size() == 8);
+  static_assert(is_sorted(table.begin(), table.end()));
+  static_assert(binary_search(table.begin(), table.end(), 40));
+  static_assert(!binary_search(table.begin(), table.end(), 90));
+  cout << "Forditasi ideju fa ok." << endl;
+}